@@ -5,6 +5,9 @@ bool App::setup() {
   Spotlight::init();
   Spotlight::allOff();
 
+  // mount flash and save the previous boot's readings if it crashed
+  recorder_.begin();
+
   if (!mpr121_.begin()) {
     Serial.print("MPR121 not found, check wiring");
     return false;
@@ -22,6 +25,19 @@ bool App::setup() {
 }
 
 void App::loopOnce() {
+  uint32_t now = millis();
+  if (last_loop_ms_ != 0 &&
+      now - last_loop_ms_ > Config::FlightRecorder::LOOP_STALL_MS) {
+    // loop recovered on its own, but was heading for a watchdog reset
+    Serial.println("Loop stall detected");
+    recorder_.freeze(FlightRecorder::Reason::LOOP_STALL);
+  }
+
+  pollSerial();
+  // serial commands (dump especially) can take a while, don't count them
+  // towards the next stall check
+  last_loop_ms_ = millis();
+
   switch (state_) {
   case Config::AppState::DEBUG:
     runDebug();
@@ -50,17 +66,40 @@ void App::runDebug() {
 // baseline tracking and delta updates
 void App::run() {
   // always take readings to turn on multiple spotlights at once
-  curr_touched_ = mpr121_.touched();
+  uint16_t touched = mpr121_.touched();
+  uint32_t now = millis();
+  recorder_.record(now, mpr121_.lastFilteredData(),
+                   mpr121_.lastBaselineData(), mpr121_.smoothedDeltas());
+
+  // health checks run on the same samples, pads it masked out are dropped
+  // from the touch bitmask so they can't hold spotlights/gestures
+  uint16_t faulted =
+      health_.update(now, mpr121_.lastFilteredData(),
+                     mpr121_.lastBaselineData(), mpr121_.lastOutOfRange(),
+                     touched);
+  if (faulted) {
+    Serial.print("Electrodes masked out: 0x");
+    Serial.println(faulted, HEX);
+    recorder_.freeze(FlightRecorder::Reason::ANOMALY);
+  }
+  curr_touched_ = touched & ~health_.faultMask();
+
+  checkAnomalies(now);
+
+  auto emit = [this](Config::Gesture::Id id, uint32_t t) { onGesture(id, t); };
+
   for (uint8_t i = 0; i < Config::Touch::NUM_ELECTRODES; i++) {
+    if ((curr_touched_ ^ last_touched_) & _BV(i)) {
+      // every edge (touch and release) goes to the gesture engine
+      gestures_.onEdge(i, curr_touched_ & _BV(i), now, emit);
+    }
     if ((curr_touched_ & _BV(i)) && !(last_touched_ & _BV(i))) {
       // if it *is* touched and *wasnt* touched before, turn on spotlight and
       // take timestamp for brief cooldown period
-      Spotlight::on(i);
-      spotlights_on_at_[i] = millis();
-      spotlight_on_[i] = true;
+      spotlightOn(i, now, Config::Spotlight::SPOTLIGHT_ON_PERIOD_MS);
     }
-    if (spotlight_on_[i] && millis() - spotlights_on_at_[i] >
-                                Config::Spotlight::SPOTLIGHT_ON_PERIOD_MS) {
+    if (spotlight_on_[i] &&
+        millis() - spotlights_on_at_[i] > spotlight_period_ms_[i]) {
       // if spotlight is on and its on period has passed, turn off and restart
       // timestamp
       Spotlight::off(i);
@@ -70,6 +109,86 @@ void App::run() {
   }
   last_touched_ = curr_touched_;
 
+  // fires hold gestures, no-op unless a gesture is waiting on a timeout
+  gestures_.tick(now, emit);
+
   // calm lil delay to prevent overwhelming mcu
   delay(10);
 }
+
+// turns a spotlight on for `period_ms`, a spotlight already on for longer
+// (e.g. from a gesture) is left alone so a plain touch can't cut it short
+void App::spotlightOn(uint8_t index, uint32_t now, uint32_t period_ms) {
+  uint32_t elapsed = now - spotlights_on_at_[index];
+  if (spotlight_on_[index] && elapsed < spotlight_period_ms_[index] &&
+      spotlight_period_ms_[index] - elapsed > period_ms) {
+    return;
+  }
+  Spotlight::on(index);
+  spotlights_on_at_[index] = now;
+  spotlight_period_ms_[index] = period_ms;
+  spotlight_on_[index] = true;
+}
+
+// higher-level reactions on top of the per-pad spotlights (gestures only
+// drive spotlights for now, there is no audio playback in the firmware yet):
+// * holding pad 2 keeps its spotlight on for the longer gesture period
+// * tapping pad 0 then pad 1 lights up every spotlight, pad 2's included
+// * touching all pads at once lights up every spotlight for the longer period
+void App::onGesture(Config::Gesture::Id id, uint32_t now) {
+  switch (id) {
+  case Config::Gesture::Id::HOLD_PAD_2:
+    spotlightOn(2, now, Config::Spotlight::GESTURE_ON_PERIOD_MS);
+    break;
+  case Config::Gesture::Id::TAP_0_THEN_1:
+    for (uint8_t i = 0; i < Config::Spotlight::SPOTLIGHT_COUNT; i++) {
+      spotlightOn(i, now, Config::Spotlight::SPOTLIGHT_ON_PERIOD_MS);
+    }
+    break;
+  case Config::Gesture::Id::CHORD_ALL:
+    for (uint8_t i = 0; i < Config::Spotlight::SPOTLIGHT_COUNT; i++) {
+      spotlightOn(i, now, Config::Spotlight::GESTURE_ON_PERIOD_MS);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+void App::pollSerial() {
+  while (Serial.available() > 0) {
+    char cmd = tolower(Serial.read());
+    if (cmd == Config::FlightRecorder::CMD_FREEZE) {
+      recorder_.freeze(FlightRecorder::Reason::SERIAL_COMMAND);
+    } else if (cmd == Config::FlightRecorder::CMD_DUMP) {
+      recorder_.dump(Serial);
+    } else if (cmd == Config::Health::CMD_REPORT) {
+      health_.report(Serial);
+    }
+  }
+}
+
+// freezes the flight recorder once per stuck touch (held far longer than
+// anyone would, i.e. a false trigger). Bad readings are handled by health_
+void App::checkAnomalies(uint32_t now) {
+  for (uint8_t i = 0; i < Config::Touch::NUM_ELECTRODES; i++) {
+    if (!(curr_touched_ & _BV(i))) {
+      touched_since_[i] = 0;
+    } else if (touched_since_[i] == 0) {
+      touched_since_[i] = now;
+    }
+
+    bool stuck =
+        touched_since_[i] != 0 &&
+        now - touched_since_[i] > Config::FlightRecorder::STUCK_TOUCH_MS;
+
+    if (!stuck) {
+      anomaly_latched_ &= ~_BV(i);
+    } else if (!(anomaly_latched_ & _BV(i))) {
+      anomaly_latched_ |= _BV(i);
+      Serial.print("Stuck touch on electrode ");
+      Serial.println(i);
+      recorder_.freeze(FlightRecorder::Reason::ANOMALY);
+    }
+  }
+}
@@ -4,6 +4,9 @@
 #include <Arduino.h>
 
 #include "Config.h"
+#include "FlightRecorder.h"
+#include "Gesture.h"
+#include "HealthMonitor.h"
 #include "MPR121.h"
 
 #ifndef _BV
@@ -19,6 +22,10 @@ public:
 private:
   void runDebug();
   void run();
+  void pollSerial();
+  void checkAnomalies(uint32_t now);
+  void onGesture(Config::Gesture::Id id, uint32_t now);
+  void spotlightOn(uint8_t index, uint32_t now, uint32_t period_ms);
 
   uint16_t last_touched_ = 0;
   uint16_t curr_touched_ = 0;
@@ -26,11 +33,38 @@ private:
   // timestamps to track when spotlights first turn on
   uint32_t spotlights_on_at_[Config::Spotlight::SPOTLIGHT_COUNT] = {0};
 
+  // how long each spotlight stays on once turned on
+  uint32_t spotlight_period_ms_[Config::Spotlight::SPOTLIGHT_COUNT] = {0};
+
   // boolean to track if a spotlight is on
   bool spotlight_on_[Config::Spotlight::SPOTLIGHT_COUNT] = {false};
 
+  // timestamp of the previous loopOnce() call, to catch loop stalls before
+  // the watchdog does
+  uint32_t last_loop_ms_ = 0;
+
+  // timestamps of when each pad started being touched (0 = not touched)
+  uint32_t touched_since_[Config::Touch::NUM_ELECTRODES] = {0};
+
+  // pads whose anomaly already triggered a freeze, cleared once it goes away
+  uint16_t anomaly_latched_ = 0;
+
+  // gestures recognized on top of the touch edges, see Gesture.h
+  static constexpr Gesture::Pattern GESTURES[] = {
+      Gesture::hold(2, Config::Gesture::HOLD_MS,
+                    Config::Gesture::Id::HOLD_PAD_2),
+      Gesture::sequence({0, 1}, Config::Gesture::SEQUENCE_WINDOW_MS,
+                        Config::Gesture::Id::TAP_0_THEN_1),
+      Gesture::chord((1 << Config::Touch::NUM_ELECTRODES) - 1,
+                     Config::Gesture::CHORD_WINDOW_MS,
+                     Config::Gesture::Id::CHORD_ALL),
+  };
+
   Config::AppState state_;
   MPR121 mpr121_;
+  FlightRecorder recorder_;
+  HealthMonitor health_;
+  Gesture::Engine<sizeof(GESTURES) / sizeof(GESTURES[0])> gestures_{GESTURES};
 };
 
 #endif
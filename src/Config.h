@@ -17,6 +17,8 @@ namespace Spotlight {
 constexpr uint8_t SPOTLIGHT_COUNT = 3;
 constexpr uint8_t SPOTLIGHT_PINS[SPOTLIGHT_COUNT] = {7, 10, 8};
 constexpr uint32_t SPOTLIGHT_ON_PERIOD_MS = 5000;
+// longer on period for gestures (hold, chord), see App::onGesture()
+constexpr uint32_t GESTURE_ON_PERIOD_MS = 15000;
 } // namespace Spotlight
 
 namespace Touch {
@@ -121,5 +123,73 @@ constexpr int16_t DELTA_RELEASE_THRESHOLD = -15;
 constexpr uint8_t DEBOUNCE_COUNT = 5;
 
 } // namespace Touch
+
+namespace FlightRecorder {
+// --- RAM RING ---
+// every RECORD_INTERVAL_MS one frame (filtered, baseline and smoothed delta
+// of each electrode) is delta + varint encoded into the ring, most frames
+// land around ~10 bytes so 64 x 1KB blocks hold roughly 4-5 minutes @ 25 Hz
+constexpr uint32_t RECORD_INTERVAL_MS = 40;
+constexpr uint16_t BLOCK_PAYLOAD_SIZE = 1024;
+constexpr uint16_t BLOCK_COUNT = 64;
+// smoothed delta is stored as fixed point (tenths of a count)
+constexpr uint8_t DELTA_SCALE = 10;
+
+// --- FLASH SNAPSHOTS ---
+// frozen rings are written to LittleFS, the oldest slot is overwritten once
+// all are used
+constexpr uint8_t SNAPSHOT_SLOTS = 4;
+// automatic triggers (anomaly, watchdog) are rate limited to save flash wear,
+// serial command freezes always go through
+constexpr uint32_t MIN_AUTO_FREEZE_INTERVAL_MS = 60000;
+
+// --- TRIGGERS ---
+// a loop iteration longer than this is treated as a watchdog pre-timeout
+constexpr uint32_t LOOP_STALL_MS = WATCHDOG_TIMEOUT_MS / 2;
+// a pad reporting touched for longer than this is considered stuck
+constexpr uint32_t STUCK_TOUCH_MS = 30000;
+// serial commands (single characters, case-insensitive)
+constexpr char CMD_FREEZE = 'f';
+constexpr char CMD_DUMP = 'd';
+} // namespace FlightRecorder
+
+namespace Gesture {
+// gestures App reacts to, patterns for them are set up in App.h
+enum class Id : uint8_t { NONE = 0, HOLD_PAD_2, TAP_0_THEN_1, CHORD_ALL };
+constexpr uint16_t HOLD_MS = 1000;           // hold a pad this long
+constexpr uint16_t SEQUENCE_WINDOW_MS = 500; // max gap between taps
+constexpr uint16_t CHORD_WINDOW_MS = 300;    // max gap between chord presses
+} // namespace Gesture
+
+namespace Health {
+// --- RANGE ---
+// filtered data has to stay within the autoconfig limits (8-bit registers
+// compared against the upper 8 bits of the 10-bit data, so scale by 4),
+// samples outside of it or with the MPR121 out-of-range bit set are bad
+constexpr uint16_t FILTERED_MIN = Touch::LSL << 2;
+constexpr uint16_t FILTERED_MAX = Touch::USL << 2;
+constexpr uint16_t FILTERED_TARGET = Touch::TL << 2;
+
+// --- NOISE FLOOR ---
+// EMA of the sample-to-sample change of filtered data while untouched, above
+// the limit the pad is close to false triggering (DELTA_TOUCH_THRESHOLD)
+constexpr float NOISE_ALPHA = 0.05f;
+constexpr float NOISE_LIMIT = 8.0f;
+
+// --- BASELINE DRIFT ---
+// baseline moving more than DRIFT_LIMIT counts within a window means the pad
+// is changing under us (lifted tape, loose wire, swapped acrylic)
+constexpr uint32_t DRIFT_WINDOW_MS = 60000;
+constexpr uint16_t DRIFT_LIMIT = 40;
+
+// --- MASKING ---
+// consecutive bad samples before a pad is masked out (~3s) and consecutive
+// good samples before it is let back in (~30s)
+constexpr uint16_t FAULT_SAMPLES = 200;
+constexpr uint16_t RECOVER_SAMPLES = 2000;
+
+// serial command printing the health report
+constexpr char CMD_REPORT = 'h';
+} // namespace Health
 } // namespace Config
 #endif
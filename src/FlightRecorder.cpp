@@ -0,0 +1,312 @@
+#include "FlightRecorder.h"
+
+#include <LittleFS.h>
+#include <esp_attr.h>
+#include <esp_system.h>
+#include <esp_task_wdt.h>
+#include <stddef.h>
+
+namespace {
+constexpr uint8_t NUM_ELECTRODES = Config::Touch::NUM_ELECTRODES;
+constexpr uint16_t BLOCK_PAYLOAD_SIZE =
+    Config::FlightRecorder::BLOCK_PAYLOAD_SIZE;
+constexpr uint16_t BLOCK_COUNT = Config::FlightRecorder::BLOCK_COUNT;
+
+// filtered, baseline, smoothed delta
+constexpr uint8_t FIELDS = 3;
+// worst case: 5 byte time delta + 3 bytes per (zigzagged int16) field
+constexpr uint8_t MAX_FRAME_SIZE = 5 + NUM_ELECTRODES * FIELDS * 3;
+
+constexpr uint32_t RING_MAGIC = 0x52464446; // "FDFR"
+constexpr char SNAPSHOT_MAGIC[4] = {'D', 'F', 'R', '1'};
+constexpr uint8_t SNAPSHOT_VERSION = 1;
+
+struct Block {
+  uint32_t start_ms; // timestamp of the first (key) frame
+  uint16_t used;     // payload bytes in use
+  uint16_t frames;   // frames encoded in the payload
+  uint8_t data[BLOCK_PAYLOAD_SIZE];
+};
+// block header is written to flash as is, must stay in sync with the decoder
+constexpr size_t BLOCK_HEADER_SIZE = offsetof(Block, data);
+static_assert(BLOCK_HEADER_SIZE == 8, "unexpected Block header padding");
+
+struct Ring {
+  uint32_t magic;
+  uint16_t head;    // block currently being written
+  uint16_t count;   // valid blocks, oldest one is (head - count + 1)
+  uint32_t last_ms; // timestamp of the last recorded frame
+  int16_t prev[NUM_ELECTRODES][FIELDS]; // previous frame, for delta encoding
+  Block blocks[BLOCK_COUNT];
+};
+
+struct __attribute__((packed)) SnapshotHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t reason;
+  uint8_t num_electrodes;
+  uint8_t delta_scale;
+  uint32_t seq;
+  uint32_t end_ms; // timestamp of the last frame in the snapshot
+  uint16_t block_count;
+  uint16_t record_interval_ms;
+};
+
+// not cleared by the startup code, contents are kept across a software,
+// watchdog or panic reset (but are garbage after a power-on)
+__NOINIT_ATTR Ring ring;
+
+uint8_t putVarint(uint8_t *out, uint32_t v) {
+  uint8_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+// maps small negative and positive numbers to small unsigned numbers
+// (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...) so they encode to a single byte
+uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+
+uint8_t encodeFrame(uint8_t *out, uint32_t dt,
+                    const int16_t values[][FIELDS],
+                    const int16_t prev[][FIELDS]) {
+  uint8_t n = putVarint(out, dt);
+  for (uint8_t i = 0; i < NUM_ELECTRODES; i++) {
+    for (uint8_t j = 0; j < FIELDS; j++) {
+      n += putVarint(out + n, zigzag((int32_t)values[i][j] - prev[i][j]));
+    }
+  }
+  return n;
+}
+
+bool ringValid() {
+  if (ring.magic != RING_MAGIC || ring.count > BLOCK_COUNT ||
+      ring.head >= BLOCK_COUNT) {
+    return false;
+  }
+  for (uint16_t i = 0; i < ring.count; i++) {
+    const Block &blk =
+        ring.blocks[(ring.head + BLOCK_COUNT - i) % BLOCK_COUNT];
+    if (blk.used > BLOCK_PAYLOAD_SIZE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void slotPath(char *path, size_t len, uint8_t slot) {
+  snprintf(path, len, "/flightrec%u.bin", slot);
+}
+} // namespace
+
+bool FlightRecorder::begin() {
+  // format on first use, the partition is otherwise unused
+  fs_ready_ = LittleFS.begin(true);
+  if (!fs_ready_) {
+    Serial.println("FlightRecorder: LittleFS mount failed, snapshots off");
+  } else {
+    // continue the sequence after the newest snapshot on flash
+    next_seq_ = 0;
+    for (uint8_t slot = 0; slot < Config::FlightRecorder::SNAPSHOT_SLOTS;
+         slot++) {
+      uint32_t seq;
+      if (readSeq(slot, seq) && seq >= next_seq_) {
+        next_seq_ = seq + 1;
+      }
+    }
+  }
+
+  // a watchdog or panic reset leaves the previous boot's ring intact, save
+  // what it saw right before going down
+  esp_reset_reason_t reason = esp_reset_reason();
+  bool crashed = reason == ESP_RST_TASK_WDT || reason == ESP_RST_INT_WDT ||
+                 reason == ESP_RST_WDT || reason == ESP_RST_PANIC;
+  if (crashed && ringValid()) {
+    freeze(Reason::WATCHDOG_RESET);
+  }
+
+  reset();
+  return fs_ready_;
+}
+
+void FlightRecorder::record(uint32_t now, const uint16_t *filtered,
+                            const uint16_t *baseline,
+                            const float *smoothDelta) {
+  if (ring.count > 0 &&
+      now - ring.last_ms < Config::FlightRecorder::RECORD_INTERVAL_MS) {
+    return;
+  }
+
+  int16_t values[NUM_ELECTRODES][FIELDS];
+  for (uint8_t i = 0; i < NUM_ELECTRODES; i++) {
+    values[i][0] = (int16_t)filtered[i];
+    values[i][1] = (int16_t)baseline[i];
+    values[i][2] =
+        (int16_t)lroundf(smoothDelta[i] * Config::FlightRecorder::DELTA_SCALE);
+  }
+
+  uint8_t frame[MAX_FRAME_SIZE];
+  uint8_t len = 0;
+  if (ring.count > 0) {
+    len = encodeFrame(frame, now - ring.last_ms, values, ring.prev);
+  }
+  if (ring.count == 0 ||
+      ring.blocks[ring.head].used + len > BLOCK_PAYLOAD_SIZE) {
+    // re-encode as a key frame (against zero) at the start of a new block
+    startBlock(now);
+    len = encodeFrame(frame, 0, values, ring.prev);
+  }
+
+  Block &blk = ring.blocks[ring.head];
+  memcpy(blk.data + blk.used, frame, len);
+  blk.used += len;
+  blk.frames++;
+
+  memcpy(ring.prev, values, sizeof(ring.prev));
+  ring.last_ms = now;
+}
+
+bool FlightRecorder::freeze(Reason reason) {
+  if (!fs_ready_ || ring.count == 0) {
+    return false;
+  }
+
+  uint32_t now = millis();
+  if (reason != Reason::SERIAL_COMMAND) {
+    uint32_t since_last = now - last_auto_freeze_ms_;
+    if (auto_frozen_ &&
+        since_last < Config::FlightRecorder::MIN_AUTO_FREEZE_INTERVAL_MS) {
+      return false;
+    }
+    auto_frozen_ = true;
+    last_auto_freeze_ms_ = now;
+  }
+
+  char path[24];
+  slotPath(path, sizeof(path),
+           next_seq_ % Config::FlightRecorder::SNAPSHOT_SLOTS);
+  File file = LittleFS.open(path, "w");
+  if (!file) {
+    Serial.print("FlightRecorder: failed to open ");
+    Serial.println(path);
+    return false;
+  }
+
+  SnapshotHeader hdr;
+  memcpy(hdr.magic, SNAPSHOT_MAGIC, sizeof(hdr.magic));
+  hdr.version = SNAPSHOT_VERSION;
+  hdr.reason = (uint8_t)reason;
+  hdr.num_electrodes = NUM_ELECTRODES;
+  hdr.delta_scale = Config::FlightRecorder::DELTA_SCALE;
+  hdr.seq = next_seq_;
+  hdr.end_ms = ring.last_ms;
+  hdr.block_count = ring.count;
+  hdr.record_interval_ms = Config::FlightRecorder::RECORD_INTERVAL_MS;
+  file.write((const uint8_t *)&hdr, sizeof(hdr));
+
+  // oldest block first
+  for (uint16_t i = 0; i < ring.count; i++) {
+    uint16_t idx = (ring.head + BLOCK_COUNT - ring.count + 1 + i) % BLOCK_COUNT;
+    const Block &blk = ring.blocks[idx];
+    file.write((const uint8_t *)&blk, BLOCK_HEADER_SIZE + blk.used);
+    // flash writes are slow, don't let them trip the watchdog
+    esp_task_wdt_reset();
+  }
+  file.close();
+
+  Serial.print("FlightRecorder: snapshot ");
+  Serial.print(next_seq_);
+  Serial.print(" (reason ");
+  Serial.print((uint8_t)reason);
+  Serial.print(") saved to ");
+  Serial.println(path);
+
+  next_seq_++;
+  return true;
+}
+
+// prints every stored snapshot as hex between BEGIN/END markers, a serial
+// log of this can be fed straight into tools/flightrec_decode.py
+void FlightRecorder::dump(Print &out) {
+  if (!fs_ready_) {
+    out.println("FlightRecorder: no filesystem");
+    return;
+  }
+
+  for (uint8_t slot = 0; slot < Config::FlightRecorder::SNAPSHOT_SLOTS;
+       slot++) {
+    char path[24];
+    slotPath(path, sizeof(path), slot);
+    if (!LittleFS.exists(path)) {
+      continue;
+    }
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+      continue;
+    }
+
+    out.print("=== FLIGHTREC BEGIN ");
+    out.print(path);
+    out.println(" ===");
+    uint8_t buf[32];
+    size_t n;
+    while ((n = file.read(buf, sizeof(buf))) > 0) {
+      for (size_t i = 0; i < n; i++) {
+        if (buf[i] < 0x10)
+          out.print("0");
+        out.print(buf[i], HEX);
+      }
+      out.println();
+      esp_task_wdt_reset();
+    }
+    out.println("=== FLIGHTREC END ===");
+    file.close();
+  }
+}
+
+void FlightRecorder::reset() {
+  ring.magic = RING_MAGIC;
+  ring.head = 0;
+  ring.count = 0;
+  ring.last_ms = 0;
+  memset(ring.prev, 0, sizeof(ring.prev));
+}
+
+void FlightRecorder::startBlock(uint32_t now) {
+  if (ring.count > 0) {
+    ring.head = (ring.head + 1) % BLOCK_COUNT;
+  }
+  if (ring.count < BLOCK_COUNT) {
+    ring.count++;
+  }
+
+  Block &blk = ring.blocks[ring.head];
+  blk.start_ms = now;
+  blk.used = 0;
+  blk.frames = 0;
+  memset(ring.prev, 0, sizeof(ring.prev));
+}
+
+bool FlightRecorder::readSeq(uint8_t slot, uint32_t &seq) {
+  char path[24];
+  slotPath(path, sizeof(path), slot);
+  if (!LittleFS.exists(path)) {
+    return false;
+  }
+  File file = LittleFS.open(path, "r");
+  if (!file) {
+    return false;
+  }
+
+  SnapshotHeader hdr;
+  bool ok = file.read((uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+            memcmp(hdr.magic, SNAPSHOT_MAGIC, sizeof(hdr.magic)) == 0;
+  file.close();
+  if (ok) {
+    seq = hdr.seq;
+  }
+  return ok;
+}
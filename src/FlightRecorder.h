@@ -0,0 +1,59 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+/**
+ * FlightRecorder.h
+ *
+ * Always-on recorder for the electrode readings. Keeps the last few minutes
+ * of filtered, baseline and smoothed delta samples of every electrode in a
+ * RAM ring and freezes a copy of it to flash when something goes wrong, so a
+ * misbehaving pad at the exhibit can be looked at after the fact.
+ *
+ * RAM ring layout:
+ *  * the ring is split into fixed size blocks, the oldest block is dropped
+ *    when a new one is needed
+ *  * every frame stores the time since the previous frame followed by each
+ *    electrode's (filtered, baseline, delta) as the difference to the
+ *    previous frame, zigzag + varint (LEB128) encoded
+ *  * the first frame of a block is encoded against zero, so every block can
+ *    be decoded on its own
+ *  * the ring lives in .noinit memory, so it survives a watchdog/panic reset
+ *    and is saved to flash on the next boot
+ *
+ * Snapshots are written to LittleFS and downloaded with the serial dump
+ * command, see tools/flightrec_decode.py for the file format and decoding.
+ */
+
+#include <Arduino.h>
+
+#include "Config.h"
+
+class FlightRecorder {
+public:
+  // stored in the snapshot header, keep values stable for the host decoder
+  enum class Reason : uint8_t {
+    SERIAL_COMMAND = 0,
+    ANOMALY = 1,
+    LOOP_STALL = 2,
+    WATCHDOG_RESET = 3,
+  };
+
+  bool begin();
+  void record(uint32_t now, const uint16_t *filtered, const uint16_t *baseline,
+              const float *smoothDelta);
+  bool freeze(Reason reason);
+  void dump(Print &out);
+
+private:
+  void reset();
+  void startBlock(uint32_t now);
+  bool readSeq(uint8_t slot, uint32_t &seq);
+
+  bool fs_ready_ = false;
+  uint32_t next_seq_ = 0;
+
+  // timestamp of the last automatic freeze, used for rate limiting
+  bool auto_frozen_ = false;
+  uint32_t last_auto_freeze_ms_ = 0;
+};
+
+#endif
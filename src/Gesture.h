@@ -0,0 +1,256 @@
+#ifndef GESTURE_H
+#define GESTURE_H
+/**
+ * Gesture.h
+ *
+ * Table-driven recognizer for higher-level touch gestures (holds, tap
+ * sequences, chords) on top of the touch bitmask edges.
+ *
+ * Gestures are mutually exclusive: the first pattern to complete wins and
+ * the others are reset and ignore input until every pad is released (if two
+ * complete on the same edge, the one listed first wins).
+ *
+ * Every pattern is a small state machine built at compile time into a
+ * transition table indexed by [state][symbol], where a symbol is a pad going
+ * down, a pad going up or the current state's timeout expiring. Feeding an
+ * edge is a single table lookup per pattern, and timeouts are only looked at
+ * while some pattern is waiting on one, so an idle engine costs one
+ * comparison per loop.
+ */
+
+#include <Arduino.h>
+
+#include "Config.h"
+
+namespace Gesture {
+using Id = Config::Gesture::Id;
+
+constexpr uint8_t NUM_PADS = Config::Touch::NUM_ELECTRODES;
+
+// --- SYMBOLS ---
+constexpr uint8_t down(uint8_t pad) { return 2 * pad; }
+constexpr uint8_t up(uint8_t pad) { return 2 * pad + 1; }
+constexpr uint8_t TIMEOUT = 2 * NUM_PADS;
+constexpr uint8_t NUM_SYMBOLS = TIMEOUT + 1;
+
+// a chord needs one state per subset of held pads, plus a "spent" flag so it
+// only fires once per press
+constexpr uint16_t MAX_STATES = 2 << NUM_PADS;
+static_assert(MAX_STATES <= 0xFF, "too many pads for 8-bit states");
+
+// no transition: state and its timeout are left as they are
+constexpr uint8_t KEEP = 0xFF;
+
+struct Transition {
+  uint8_t next;
+  Id emit;
+};
+
+struct Pattern {
+  Transition table[MAX_STATES][NUM_SYMBOLS];
+  uint16_t timeout_ms[MAX_STATES]; // armed when entering the state, 0 = none
+};
+
+// pattern where every symbol is ignored, builders fill in the rest
+constexpr Pattern empty() {
+  Pattern p{};
+  for (uint16_t s = 0; s < MAX_STATES; s++) {
+    for (uint8_t sym = 0; sym < NUM_SYMBOLS; sym++) {
+      p.table[s][sym] = {KEEP, Id::NONE};
+    }
+  }
+  return p;
+}
+
+// fires once `pad` has been held for `hold_ms`
+constexpr Pattern hold(uint8_t pad, uint16_t hold_ms, Id id) {
+  // 0: released, 1: held and timing, 2: held and already fired
+  Pattern p = empty();
+  p.table[0][down(pad)] = {1, Id::NONE};
+  p.table[1][up(pad)] = {0, Id::NONE};
+  p.table[1][TIMEOUT] = {2, id};
+  p.table[2][up(pad)] = {0, Id::NONE};
+  p.timeout_ms[1] = hold_ms;
+  return p;
+}
+
+// fires when `pads` are tapped in order: each pad is released before the
+// next one goes down, and every press/release comes within `window_ms` of
+// the previous one. The last pad fires on its press. Pressing any other pad
+// breaks the sequence (unless it is the first one, which starts it over)
+template <size_t K>
+constexpr Pattern sequence(const uint8_t (&pads)[K], uint16_t window_ms,
+                           Id id) {
+  static_assert(K >= 2 && 2 * K - 1 <= MAX_STATES, "bad sequence length");
+  // state 2s+1: pads[s] held, waiting for its release
+  // state 2s+2: pads[s] tapped, waiting for pads[s+1]
+  Pattern p = empty();
+  p.table[0][down(pads[0])] = {1, Id::NONE};
+  for (uint8_t s = 0; s < K - 1; s++) {
+    uint8_t held = 2 * s + 1;
+    uint8_t tapped = 2 * s + 2;
+
+    for (uint8_t pad = 0; pad < NUM_PADS; pad++) {
+      // a second pad going down while one is held is a chord, not a tap
+      p.table[held][down(pad)] = {0, Id::NONE};
+      p.table[tapped][down(pad)] = {(uint8_t)(pad == pads[0] ? 1 : 0),
+                                    Id::NONE};
+    }
+    p.table[held][up(pads[s])] = {tapped, Id::NONE};
+    if (s == K - 2) {
+      p.table[tapped][down(pads[s + 1])] = {0, id};
+    } else {
+      p.table[tapped][down(pads[s + 1])] = {(uint8_t)(tapped + 1), Id::NONE};
+    }
+
+    p.table[held][TIMEOUT] = {0, Id::NONE};
+    p.table[tapped][TIMEOUT] = {0, Id::NONE};
+    p.timeout_ms[held] = window_ms;
+    p.timeout_ms[tapped] = window_ms;
+  }
+  return p;
+}
+
+// fires once every pad in `mask` is held, each one pressed within
+// `window_ms` of the previous. Fires again only after all of them are
+// released. Pads outside the mask are ignored
+constexpr Pattern chord(uint8_t mask, uint16_t window_ms, Id id) {
+  // state: bitmask of held chord pads | SPENT once fired or timed out
+  constexpr uint8_t SPENT = 1 << NUM_PADS;
+  Pattern p = empty();
+  for (uint16_t s = 0; s < MAX_STATES; s++) {
+    uint8_t held = s & (SPENT - 1);
+    uint8_t spent = s & SPENT;
+    if (held & ~mask) {
+      continue; // unreachable
+    }
+
+    for (uint8_t pad = 0; pad < NUM_PADS; pad++) {
+      uint8_t bit = 1 << pad;
+      if (!(mask & bit)) {
+        continue;
+      }
+      if (!(held & bit)) {
+        uint8_t next = held | bit;
+        if (!spent && next == mask) {
+          p.table[s][down(pad)] = {(uint8_t)(next | SPENT), id};
+        } else {
+          p.table[s][down(pad)] = {(uint8_t)(next | spent), Id::NONE};
+        }
+      } else {
+        uint8_t next = held & ~bit;
+        p.table[s][up(pad)] = {(uint8_t)(next ? next | spent : 0), Id::NONE};
+      }
+    }
+
+    if (!spent && held) {
+      p.table[s][TIMEOUT] = {(uint8_t)(held | SPENT), Id::NONE};
+      p.timeout_ms[s] = window_ms;
+    }
+  }
+  return p;
+}
+
+template <size_t N> class Engine {
+public:
+  static_assert(N <= 32, "armed_ holds one bit per pattern");
+
+  constexpr explicit Engine(const Pattern (&patterns)[N])
+      : patterns_(patterns) {}
+
+  // feed one touch edge, `emit(Id, now)` is called for the gesture it
+  // completes (if any)
+  template <typename Emit>
+  void onEdge(uint8_t pad, bool pressed, uint32_t now, Emit &&emit) {
+    if (pad >= NUM_PADS) {
+      return;
+    }
+    if (pressed) {
+      held_ |= (1UL << pad);
+    } else {
+      held_ &= ~(1UL << pad);
+    }
+
+    uint8_t sym = pressed ? down(pad) : up(pad);
+    for (uint8_t i = 0; i < N; i++) {
+      step(i, sym, now, emit);
+    }
+
+    if (held_ == 0) {
+      // everything released, all patterns compete again
+      suppressed_ = 0;
+    }
+  }
+
+  // expire timeouts, returns right away unless a pattern is waiting on one
+  template <typename Emit> void tick(uint32_t now, Emit &&emit) {
+    if (armed_ == 0 || (int32_t)(now - next_deadline_) < 0) {
+      return;
+    }
+    for (uint8_t i = 0; i < N; i++) {
+      if ((armed_ & (1UL << i)) && (int32_t)(now - deadline_[i]) >= 0) {
+        step(i, TIMEOUT, now, emit);
+      }
+    }
+  }
+
+private:
+  template <typename Emit>
+  void step(uint8_t i, uint8_t sym, uint32_t now, Emit &emit) {
+    if (suppressed_ & (1UL << i)) {
+      return;
+    }
+    const Transition &t = patterns_[i].table[state_[i]][sym];
+    if (t.next == KEEP) {
+      return;
+    }
+
+    state_[i] = t.next;
+    uint16_t timeout = patterns_[i].timeout_ms[t.next];
+    if (timeout) {
+      armed_ |= (1UL << i);
+      deadline_[i] = now + timeout;
+    } else {
+      armed_ &= ~(1UL << i);
+    }
+
+    if (t.emit != Id::NONE) {
+      suppressOthers(i);
+      emit(t.emit, now);
+    }
+    updateNextDeadline(now);
+  }
+
+  // gestures are mutually exclusive: the first one to complete resets every
+  // other pattern and keeps them out until all pads are released
+  void suppressOthers(uint8_t winner) {
+    for (uint8_t j = 0; j < N; j++) {
+      if (j != winner) {
+        state_[j] = 0;
+        armed_ &= ~(1UL << j);
+        suppressed_ |= (1UL << j);
+      }
+    }
+  }
+
+  void updateNextDeadline(uint32_t now) {
+    int32_t soonest = INT32_MAX;
+    for (uint8_t i = 0; i < N; i++) {
+      if ((armed_ & (1UL << i)) && (int32_t)(deadline_[i] - now) < soonest) {
+        soonest = (int32_t)(deadline_[i] - now);
+      }
+    }
+    next_deadline_ = now + soonest;
+  }
+
+  const Pattern *patterns_;
+  uint8_t state_[N] = {0};
+  uint32_t deadline_[N] = {0};
+  uint32_t armed_ = 0;
+  uint32_t next_deadline_ = 0;
+  uint32_t suppressed_ = 0; // patterns locked out by a completed gesture
+  uint32_t held_ = 0;       // pads currently down, as seen through the edges
+};
+} // namespace Gesture
+
+#endif
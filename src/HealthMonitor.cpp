@@ -0,0 +1,124 @@
+#include "HealthMonitor.h"
+
+uint16_t HealthMonitor::update(uint32_t now, const uint16_t *filtered,
+                               const uint16_t *baseline, uint16_t outOfRange,
+                               uint16_t touched) {
+  uint16_t newly_faulted = 0;
+
+  if (!has_prev_) {
+    window_start_ms_ = now;
+    for (uint8_t i = 0; i < Config::Touch::NUM_ELECTRODES; i++) {
+      window_baseline_[i] = baseline[i];
+    }
+  }
+  bool window_done = now - window_start_ms_ >= Config::Health::DRIFT_WINDOW_MS;
+
+  for (uint8_t i = 0; i < Config::Touch::NUM_ELECTRODES; i++) {
+    PadHealth &p = pads_[i];
+    uint16_t bit = 1 << i;
+
+    // --- RANGE ---
+    bool oor = outOfRange & bit;
+    bool out_of_limits = filtered[i] < Config::Health::FILTERED_MIN ||
+                         filtered[i] > Config::Health::FILTERED_MAX;
+    if (oor) {
+      p.oor_samples++;
+    }
+    if (out_of_limits) {
+      p.range_samples++;
+    }
+
+    // --- NOISE FLOOR ---
+    // skip samples around touches, those steps are signal not noise
+    if (has_prev_ && !((touched | prev_touched_) & bit)) {
+      float step = abs((int16_t)filtered[i] - (int16_t)prev_filtered_[i]);
+      p.noise += Config::Health::NOISE_ALPHA * (step - p.noise);
+    }
+    prev_filtered_[i] = filtered[i];
+    bool noisy = p.noise > Config::Health::NOISE_LIMIT;
+    if (noisy) {
+      p.noisy_samples++;
+    }
+
+    // --- BASELINE DRIFT ---
+    if (window_done) {
+      p.drift = (int16_t)baseline[i] - (int16_t)window_baseline_[i];
+      drifting_[i] = abs(p.drift) > Config::Health::DRIFT_LIMIT;
+      if (drifting_[i]) {
+        p.drift_windows++;
+      }
+      window_baseline_[i] = baseline[i];
+    }
+
+    // --- STATE (w/ hysteresis) ---
+    if (oor || out_of_limits || noisy) {
+      good_streak_[i] = 0;
+      if (bad_streak_[i] < Config::Health::FAULT_SAMPLES) {
+        bad_streak_[i]++;
+      }
+    } else {
+      bad_streak_[i] = 0;
+      if (good_streak_[i] < Config::Health::RECOVER_SAMPLES) {
+        good_streak_[i]++;
+      }
+    }
+
+    if (p.state == State::FAULT) {
+      if (good_streak_[i] >= Config::Health::RECOVER_SAMPLES) {
+        // let the pad back in
+        p.state = State::OK;
+        fault_mask_ &= ~bit;
+      }
+    } else if (bad_streak_[i] >= Config::Health::FAULT_SAMPLES) {
+      p.state = State::FAULT;
+      p.faults++;
+      fault_mask_ |= bit;
+      newly_faulted |= bit;
+    } else {
+      p.state = (bad_streak_[i] || drifting_[i]) ? State::DEGRADED : State::OK;
+    }
+  }
+
+  if (window_done) {
+    window_start_ms_ = now;
+  }
+  prev_touched_ = touched;
+  has_prev_ = true;
+
+  return newly_faulted;
+}
+
+void HealthMonitor::report(Print &out) const {
+  static const char *STATE_NAMES[] = {"OK", "DEGRADED", "FAULT"};
+
+  out.println("\n======= ELECTRODE HEALTH =======");
+  out.print("Limits: LSL=");
+  out.print(Config::Health::FILTERED_MIN);
+  out.print(", TL=");
+  out.print(Config::Health::FILTERED_TARGET);
+  out.print(", USL=");
+  out.println(Config::Health::FILTERED_MAX);
+  out.println("Electrode, State, Noise, Drift, OOR, Range, Noisy, "
+              "DriftWindows, Faults");
+  for (uint8_t i = 0; i < Config::Touch::NUM_ELECTRODES; i++) {
+    const PadHealth &p = pads_[i];
+    out.print(i);
+    out.print(",");
+    out.print(STATE_NAMES[(uint8_t)p.state]);
+    out.print(",");
+    out.print(p.noise);
+    out.print(",");
+    out.print(p.drift);
+    out.print(",");
+    out.print(p.oor_samples);
+    out.print(",");
+    out.print(p.range_samples);
+    out.print(",");
+    out.print(p.noisy_samples);
+    out.print(",");
+    out.print(p.drift_windows);
+    out.print(",");
+    out.println(p.faults);
+  }
+  out.println("================================\n");
+}
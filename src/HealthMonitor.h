@@ -0,0 +1,68 @@
+#ifndef HEALTH_MONITOR_H
+#define HEALTH_MONITOR_H
+/**
+ * HealthMonitor.h
+ *
+ * Background health checks for the electrodes, fed with the samples touched()
+ * already read (no extra bus traffic). Per pad it watches:
+ *  * filtered data against the autoconfig limits (LSL/USL, TL for reference)
+ *    and the MPR121 out-of-range status bit
+ *  * noise floor of the untouched filtered data
+ *  * baseline drift rate
+ *
+ * Range and noise problems make a sample bad, drift only marks the pad as
+ * degraded. A pad that stays bad for FAULT_SAMPLES in a row is masked out of
+ * the touch bitmask until it has been good for RECOVER_SAMPLES in a row.
+ */
+
+#include <Arduino.h>
+
+#include "Config.h"
+
+class HealthMonitor {
+public:
+  enum class State : uint8_t { OK, DEGRADED, FAULT };
+
+  struct PadHealth {
+    State state = State::OK;
+    float noise = 0.0f; // noise floor, counts
+    int16_t drift = 0;  // baseline change over the last drift window
+
+    // counters since boot
+    uint32_t oor_samples = 0;   // OOR status bit set
+    uint32_t range_samples = 0; // filtered data outside LSL..USL
+    uint32_t noisy_samples = 0; // noise floor above NOISE_LIMIT
+    uint16_t drift_windows = 0; // windows with drift above DRIFT_LIMIT
+    uint16_t faults = 0;        // times the pad got masked out
+  };
+
+  // returns the pads that were masked out by this sample
+  uint16_t update(uint32_t now, const uint16_t *filtered,
+                  const uint16_t *baseline, uint16_t outOfRange,
+                  uint16_t touched);
+
+  const PadHealth &pad(uint8_t electrode) const { return pads_[electrode]; }
+  uint16_t faultMask() const { return fault_mask_; }
+  void report(Print &out) const;
+
+private:
+  PadHealth pads_[Config::Touch::NUM_ELECTRODES];
+  uint16_t fault_mask_ = 0;
+
+  // per pad tracking state
+  uint16_t bad_streak_[Config::Touch::NUM_ELECTRODES] = {0};
+  uint16_t good_streak_[Config::Touch::NUM_ELECTRODES] = {0};
+  uint16_t prev_filtered_[Config::Touch::NUM_ELECTRODES] = {0};
+  bool drifting_[Config::Touch::NUM_ELECTRODES] = {false};
+
+  // previous sample's touch bitmask, noise is only tracked between two
+  // untouched samples
+  uint16_t prev_touched_ = 0;
+  bool has_prev_ = false;
+
+  // drift window, shared by all pads
+  uint32_t window_start_ms_ = 0;
+  uint16_t window_baseline_[Config::Touch::NUM_ELECTRODES] = {0};
+};
+
+#endif
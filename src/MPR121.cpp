@@ -169,12 +169,45 @@ void MPR121::setAutoconfig(boolean autoconfig) {
   }
 }
 
+// reads OOR status + filtered data of all used electrodes in one burst and
+// their baselines in a second one (register address auto-increments), instead
+// of one transaction per register
+void MPR121::readSamples() {
+  constexpr uint8_t N = Config::Touch::NUM_ELECTRODES;
+
+  // 0x02-0x03 OOR status, then 2 filtered data bytes per electrode
+  uint8_t status[2 + 2 * N];
+  Adafruit_BusIO_Register status_regs =
+      Adafruit_BusIO_Register(i2c_dev, MPR121_OORSTATUS_L, sizeof(status));
+  if (!status_regs.read(status, sizeof(status))) {
+    // same as a failed single register read (all ones)
+    memset(status, 0xFF, sizeof(status));
+  }
+
+  uint8_t baseline[N];
+  Adafruit_BusIO_Register baseline_regs =
+      Adafruit_BusIO_Register(i2c_dev, MPR121_BASELINE_0, sizeof(baseline));
+  if (!baseline_regs.read(baseline, sizeof(baseline))) {
+    memset(baseline, 0xFF, sizeof(baseline));
+  }
+
+  lastOOR = ((uint16_t)status[1] << 8) | status[0];
+  for (uint8_t i = 0; i < N; i++) {
+    uint8_t lsb = status[2 + 2 * i];
+    uint8_t msb = status[3 + 2 * i];
+    lastFiltered[i] = ((uint16_t)(msb & 0x03) << 8) | lsb;
+    lastBaseline[i] = (uint16_t)baseline[i] << 2;
+  }
+}
+
 uint16_t MPR121::touched() {
   uint16_t touchMask = 0;
 
+  readSamples();
+
   for (uint8_t i = 0; i < Config::Touch::NUM_ELECTRODES; i++) {
-    uint16_t f = filteredData(i);
-    uint16_t b = baselineData(i);
+    uint16_t f = lastFiltered[i];
+    uint16_t b = lastBaseline[i];
     int16_t d = (int16_t)f - (int16_t)b;
 
     // smoothen out delta readings with ema filter
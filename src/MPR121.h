@@ -15,6 +15,10 @@ enum {
   MPR121_TOUCHSTATUS_L = 0x00,
   MPR121_TOUCHSTATUS_H = 0x01,
 
+  // --- Out-Of-Range Status Registers ---
+  MPR121_OORSTATUS_L = 0x02, // electrodes 0-7
+  MPR121_OORSTATUS_H = 0x03, // electrodes 8-11 + ARFF (bit 6) + ACFF (bit 7)
+
   // --- Initial Filtered Data Registers ---
   MPR121_FILTDATA_0L = 0x04, // 8 least-siginificant bits of electrode 0
   MPR121_FILTDATA_0H = 0x05, // 2 most-significant bits of electrode 0
@@ -87,13 +91,25 @@ public:
 
   uint16_t touched();
 
+  // readings fetched by the last touched() call, one entry per electrode
+  const uint16_t *lastFilteredData() const { return lastFiltered; }
+  const uint16_t *lastBaselineData() const { return lastBaseline; }
+  const float *smoothedDeltas() const { return smoothDelta; }
+  uint16_t lastOutOfRange() const { return lastOOR; }
+
   void verifyRegisters();
   void dumpCapData(uint8_t electrode);
   void dumpCDCandCDTRegisters();
 
 private:
+  void readSamples();
+
   Adafruit_I2CDevice *i2c_dev = NULL;
 
+  uint16_t lastOOR = 0;
+
+  uint16_t lastFiltered[Config::Touch::NUM_ELECTRODES] = {0};
+  uint16_t lastBaseline[Config::Touch::NUM_ELECTRODES] = {0};
   float smoothDelta[Config::Touch::NUM_ELECTRODES] = {0.0f};
   uint8_t touchDebounceCount[Config::Touch::NUM_ELECTRODES] = {0};
   uint8_t releaseDebounceCount[Config::Touch::NUM_ELECTRODES] = {0};
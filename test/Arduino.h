@@ -0,0 +1,11 @@
+#pragma once
+/**
+ * Arduino.h (host stub)
+ *
+ * Just enough of the Arduino core for the header-only modules under src/ to
+ * compile on the host for tests. Not used by the firmware build.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
@@ -0,0 +1,196 @@
+/**
+ * gesture_test.cpp
+ *
+ * Host test for the gesture engine (src/Gesture.h), driven with synthetic
+ * touch edge sequences. See README for how to build and run it.
+ */
+
+#include <stdio.h>
+
+#include "Gesture.h"
+
+using Config::Gesture::Id;
+
+namespace {
+constexpr uint8_t ALL_PADS = (1 << Config::Touch::NUM_ELECTRODES) - 1;
+
+constexpr Gesture::Pattern PATTERNS[] = {
+    Gesture::hold(2, Config::Gesture::HOLD_MS, Id::HOLD_PAD_2),
+    Gesture::sequence({0, 1}, Config::Gesture::SEQUENCE_WINDOW_MS,
+                      Id::TAP_0_THEN_1),
+    Gesture::chord(ALL_PADS, Config::Gesture::CHORD_WINDOW_MS, Id::CHORD_ALL),
+};
+
+// everything the engine emitted since the last clear
+Id events[16];
+uint8_t event_count = 0;
+uint32_t event_time[16];
+
+int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+struct Harness {
+  Gesture::Engine<sizeof(PATTERNS) / sizeof(PATTERNS[0])> engine{PATTERNS};
+
+  static void emit(Id id, uint32_t now) {
+    if (event_count < sizeof(events) / sizeof(events[0])) {
+      event_time[event_count] = now;
+      events[event_count++] = id;
+    }
+  }
+  void press(uint8_t pad, uint32_t now) { engine.onEdge(pad, true, now, emit); }
+  void release(uint8_t pad, uint32_t now) {
+    engine.onEdge(pad, false, now, emit);
+  }
+  void tap(uint8_t pad, uint32_t now) {
+    press(pad, now);
+    release(pad, now + 50);
+  }
+  void tick(uint32_t now) { engine.tick(now, emit); }
+};
+
+void clearEvents() { event_count = 0; }
+
+void testHoldFiresAtHoldMs() {
+  Harness h;
+  clearEvents();
+  h.press(2, 1000);
+  h.tick(1000 + Config::Gesture::HOLD_MS - 1);
+  CHECK(event_count == 0);
+  h.tick(1000 + Config::Gesture::HOLD_MS);
+  CHECK(event_count == 1 && events[0] == Id::HOLD_PAD_2);
+  CHECK(event_time[0] == 1000 + Config::Gesture::HOLD_MS);
+
+  // keeps quiet while still held, fires again on the next hold
+  h.tick(10000);
+  CHECK(event_count == 1);
+  h.release(2, 10000);
+  h.press(2, 11000);
+  h.tick(11000 + Config::Gesture::HOLD_MS);
+  CHECK(event_count == 2 && events[1] == Id::HOLD_PAD_2);
+}
+
+void testHoldReleasedEarlyDoesNotFire() {
+  Harness h;
+  clearEvents();
+  h.press(2, 1000);
+  h.release(2, 1000 + Config::Gesture::HOLD_MS - 1);
+  h.tick(1000 + 5 * Config::Gesture::HOLD_MS);
+  CHECK(event_count == 0);
+}
+
+void testSequenceInsideWindow() {
+  Harness h;
+  clearEvents();
+  h.tap(0, 1000);
+  h.press(1, 1050 + Config::Gesture::SEQUENCE_WINDOW_MS - 1);
+  CHECK(event_count == 1 && events[0] == Id::TAP_0_THEN_1);
+}
+
+void testSequenceOutsideWindow() {
+  Harness h;
+  clearEvents();
+  h.tap(0, 1000);
+  h.tick(1050 + Config::Gesture::SEQUENCE_WINDOW_MS);
+  h.press(1, 1050 + Config::Gesture::SEQUENCE_WINDOW_MS + 1);
+  CHECK(event_count == 0);
+
+  // another pad in between breaks the sequence too
+  h.release(1, 3000);
+  h.tap(0, 4000);
+  h.tap(2, 4100);
+  h.press(1, 4200);
+  CHECK(event_count == 0);
+}
+
+void testSequenceNeedsTaps() {
+  // 0 still held when 1 goes down is a chord attempt, not a sequence
+  Harness h;
+  clearEvents();
+  h.press(0, 1000);
+  h.press(1, 1100);
+  CHECK(event_count == 0);
+}
+
+void testChordFiresOncePerPress() {
+  Harness h;
+  clearEvents();
+  for (uint8_t pad = 0; pad < Config::Touch::NUM_ELECTRODES; pad++) {
+    h.press(pad, 1000 + pad * 100);
+  }
+  CHECK(event_count == 1 && events[0] == Id::CHORD_ALL);
+
+  // holding on does not fire the pad 2 hold, lifting and pressing one pad
+  // again does not fire the chord again
+  h.tick(5000);
+  h.release(0, 5000);
+  h.press(0, 5100);
+  h.tick(10000);
+  CHECK(event_count == 1);
+
+  // after a full release it fires again
+  for (uint8_t pad = 0; pad < Config::Touch::NUM_ELECTRODES; pad++) {
+    h.release(pad, 11000);
+  }
+  for (uint8_t pad = 0; pad < Config::Touch::NUM_ELECTRODES; pad++) {
+    h.press(pad, 12000 + pad * 100);
+  }
+  CHECK(event_count == 2 && events[1] == Id::CHORD_ALL);
+}
+
+void testChordTooSlow() {
+  Harness h;
+  clearEvents();
+  h.press(0, 1000);
+  h.tick(1000 + Config::Gesture::CHORD_WINDOW_MS);
+  h.press(1, 1000 + Config::Gesture::CHORD_WINDOW_MS + 10);
+  h.press(2, 1000 + Config::Gesture::CHORD_WINDOW_MS + 20);
+  CHECK(event_count == 0);
+}
+
+void testTimeoutAcrossMillisWrap() {
+  Harness h;
+  clearEvents();
+  uint32_t start = 0xFFFFFFFFu - Config::Gesture::HOLD_MS / 2;
+  h.press(2, start);
+  h.tick(start + Config::Gesture::HOLD_MS / 2); // wrapped to ~0
+  CHECK(event_count == 0);
+  h.tick(start + Config::Gesture::HOLD_MS - 1);
+  CHECK(event_count == 0);
+  h.tick(start + Config::Gesture::HOLD_MS);
+  CHECK(event_count == 1 && events[0] == Id::HOLD_PAD_2);
+
+  // sequence window across the wrap
+  h.release(2, start + 2 * Config::Gesture::HOLD_MS);
+  clearEvents();
+  uint32_t seq = 0xFFFFFFFFu - 100;
+  h.tap(0, seq);
+  h.press(1, seq + 200);
+  CHECK(event_count == 1 && events[0] == Id::TAP_0_THEN_1);
+}
+} // namespace
+
+int main() {
+  testHoldFiresAtHoldMs();
+  testHoldReleasedEarlyDoesNotFire();
+  testSequenceInsideWindow();
+  testSequenceOutsideWindow();
+  testSequenceNeedsTaps();
+  testChordFiresOncePerPress();
+  testChordTooSlow();
+  testTimeoutAcrossMillisWrap();
+
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("all gesture tests passed\n");
+  return 0;
+}
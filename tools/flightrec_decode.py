@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+flightrec_decode.py
+
+Decodes flight recorder snapshots (see src/FlightRecorder.h) into CSV.
+
+Input is either a raw snapshot file or a serial log captured while sending
+the dump command ('d'); every BEGIN/END block in the log is decoded.
+
+Output columns match the debug mode CSV, with the snapshot and timestamp in
+front: seq,reason,time_ms,electrode,filtered,baseline,delta
+
+usage: flightrec_decode.py <serial.log | flightrecN.bin> [-o out.csv]
+"""
+
+import argparse
+import csv
+import re
+import struct
+import sys
+
+SNAPSHOT_MAGIC = b"DFR1"
+# magic, version, reason, num_electrodes, delta_scale, seq, end_ms,
+# block_count, record_interval_ms
+HEADER = struct.Struct("<4sBBBBIIHH")
+# start_ms, used, frames
+BLOCK_HEADER = struct.Struct("<IHH")
+FIELDS = 3  # filtered, baseline, smoothed delta
+
+REASONS = {0: "serial", 1: "anomaly", 2: "loop_stall", 3: "watchdog_reset"}
+
+
+def read_varint(buf, pos):
+    value = shift = 0
+    while True:
+        b = buf[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if b < 0x80:
+            return value, pos
+        shift += 7
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def decode_snapshot(data):
+    magic, version, reason, num_elec, delta_scale, seq, end_ms, block_count, _ = (
+        HEADER.unpack_from(data, 0)
+    )
+    if magic != SNAPSHOT_MAGIC or version != 1:
+        raise ValueError("not a version 1 flight recorder snapshot")
+
+    reason = REASONS.get(reason, str(reason))
+    pos = HEADER.size
+    for _ in range(block_count):
+        start_ms, used, frames = BLOCK_HEADER.unpack_from(data, pos)
+        pos += BLOCK_HEADER.size
+        payload, pos = data[pos : pos + used], pos + used
+
+        # every block starts with a key frame encoded against zero
+        prev = [[0] * FIELDS for _ in range(num_elec)]
+        t = start_ms
+        p = 0
+        for _ in range(frames):
+            dt, p = read_varint(payload, p)
+            t += dt
+            for e in range(num_elec):
+                for f in range(FIELDS):
+                    v, p = read_varint(payload, p)
+                    prev[e][f] += unzigzag(v)
+                filtered, baseline, delta = prev[e]
+                yield (seq, reason, t, e, filtered, baseline,
+                       round(delta / delta_scale, 2))
+
+
+def snapshots_from_log(text):
+    for m in re.finditer(
+        r"=== FLIGHTREC BEGIN .*?===\s*\n(.*?)=== FLIGHTREC END ===", text, re.S
+    ):
+        yield bytes.fromhex("".join(m.group(1).split()))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("input", help="serial log or raw snapshot file")
+    parser.add_argument("-o", "--output", help="csv file (default: stdout)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        raw = f.read()
+    if raw.startswith(SNAPSHOT_MAGIC):
+        snapshots = [raw]
+    else:
+        snapshots = list(snapshots_from_log(raw.decode(errors="replace")))
+    if not snapshots:
+        sys.exit("no snapshots found in " + args.input)
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(
+        ["seq", "reason", "time_ms", "electrode", "filtered", "baseline", "delta"]
+    )
+    # oldest snapshot first
+    for data in sorted(snapshots, key=lambda d: HEADER.unpack_from(d, 0)[5]):
+        writer.writerows(decode_snapshot(data))
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()